@@ -4,6 +4,8 @@
 // Moose includes
 #include "Transient.h"
 #include "MoabUserObject.h"
+#include "WalkingMOABMesh.h"
+#include "BankedSource.h"
 
 // DagMC includes
 #include "DagMC.hpp"
@@ -12,6 +14,7 @@
 #define DAGMC 1
 
 // OpenMC includes
+#include "openmc/bank.h" // simulation::source_bank
 #include "openmc/capi.h"
 #include "openmc/cell.h"
 #include "openmc/constants.h" // enum RunMode
@@ -21,13 +24,19 @@
 #include "openmc/file_utils.h"
 #include "openmc/geometry.h" // overlap_check_count
 #include "openmc/geometry_aux.h" // finalize geometry
+#include "openmc/lattice.h"
 #include "openmc/material.h"
+#include "openmc/math_functions.h" // calc_zn, calc_pn_c
 #include "openmc/mesh.h"
 #include "openmc/message_passing.h"
 #include "openmc/mgxs_interface.h" // data::mg
 #include "openmc/nuclide.h" // data::nuclide_map
 #include "openmc/output.h" // print_plot
 #include "openmc/plot.h"
+#include "openmc/tallies/filter_cell.h"
+#include "openmc/tallies/filter_material.h"
+#include "openmc/tallies/filter_sptl_legendre.h"
+#include "openmc/tallies/filter_zernike.h"
 #include "openmc/tallies/filter_mesh.h"
 #include "openmc/tallies/filter.h"
 #include "openmc/tallies/tally.h"
@@ -37,10 +46,13 @@
 #include "openmc/string_utils.h"
 #include "openmc/summary.h"
 #include "openmc/surface.h"
+#include "openmc/weight_windows.h"
 #include "xtensor/xio.hpp"
 
 #include "uwuw.hpp"
 
+#include <future>
+
 class OpenMCExecutioner;
 
 /// \brief Our bespoke Executioner class to perform OpenMC runs
@@ -88,12 +100,34 @@ private:
     std::string err_name;
     /// Switch to control if we save the error
     bool saveErr;
+    /// Switch to control if we compute the variance
+    bool calcVar;
     /// Factor by which we need to multiply results to get desired units
     double scale_factor;
     /// Index for the score in the tally
     int index;
   };
 
+  /// \brief Helper struct to store the IDs referenced by a static cell
+  struct StaticCellIDs {
+    /// ID of the universe containing the cell
+    int32_t universe;
+    /// ID of the filling universe or lattice (C_NONE if filled with material)
+    int32_t fill;
+    /// IDs of the filling materials
+    std::vector<int32_t> materials;
+  };
+
+  /// \brief Helper struct to store the history of relaxed results
+  struct RelaxData {
+    /// Number of iterations included in the relaxed results
+    unsigned int nIts;
+    /// Relaxed mean for each mesh bin
+    std::vector<double> mean;
+    /// Relaxed variance of the mean for each mesh bin
+    std::vector<double> var;
+  };
+
   // Methods
 
   /// Get the moab user object
@@ -105,12 +139,54 @@ private:
   /// Initialise MOAB/OpenMC
   void initialize();
 
+  /// Consume results of the previous step's run and launch the next one
+  void executeLagged();
+
+  /// Commands sent to transport helpers
+  enum HelperCommand { HELPER_STEP=0, HELPER_FINISH=1 };
+
+  /// Run transport alongside the app we help, one step at a time, until it finishes
+  void executeHelper();
+
+  /// Send a command to the transport helpers (master only)
+  void commandHelpers(HelperCommand command);
+
+  /// Send the MOAB geometry to the transport helpers, or receive it on a helper
+  bool shareGeometry();
+
+  /// Launch an OpenMC run in the background
+  void launchRun();
+
+  /// Wait for a background OpenMC run to finish
+  bool waitForRun();
+
+  /// Save the fission source of an eigenvalue run to seed the next one
+  bool keepSource();
+
+  /// Decide whether the inputs have changed little enough to reuse the last transport solve
+  bool skipTransport();
+
   /// Run OpenMC and get results
   bool run();
 
   /// Pass results into FEProblem
   bool processResults();
 
+  /// Broadcast results to ranks which did not run OpenMC
+  bool shareResults(std::map<std::string,std::vector< double > > & var_results_by_elem, bool success);
+
+  /// Set weight windows on the tally mesh from the flux of the last run
+  bool updateWeightWindows(std::map<std::string,std::vector< double > > & var_results_by_elem);
+
+  /// Send each rank the results for the bins of its local elements only
+  bool scatterResults(std::map<std::string,std::vector< double > > & var_results_by_elem, bool success);
+
+  /// Replace a full results vector on the master with the local bins on every rank
+  void scatterResult(std::vector< double > & results);
+
+  /// Collect on the master the bins needed by each rank
+  void updateResultBins();
+
   /// Output the results
   bool output();
 
@@ -123,9 +199,33 @@ private:
   /// Initialise OpenMC
   bool initOpenMC();
 
+  /// Initialise MOAB and OpenMC on separate threads
+  void initConcurrently();
+
+  /// Set the communicator to pass to OpenMC
+  void setOpenMCComm();
+
+  /// Call OpenMC's initialisation routine (warning is set if clean up failed, for the main thread to report)
+  bool startOpenMC(std::string& warning);
+
+  /// Write OpenMC inputs with a placeholder geometry to a unique staging directory
+  bool stagePlaceholderInput(std::string& path);
+
+  /// Remove the staging directory once OpenMC has read its inputs (false if it could not be removed)
+  bool removePlaceholderInput(const std::string& path);
+
+  /// Check if a DAGMC file in geometry.xml carries a UWUW material library
+  bool geometryUsesUWUW();
+
   /// Initialise booking of DAGMC universe
   bool initDAGUniverse();
 
+  /// Save the IDs referenced by static cells and lattices, which finalize_geometry replaces by indices
+  void saveStaticIDs();
+
+  /// Put back the IDs referenced by static cells and lattices, ready for finalize_geometry
+  void restoreStaticIDs();
+
   /// Initialise material maps of names to ids
   bool initMaterials();
 
@@ -140,11 +240,18 @@ private:
 
   /// Process Tallies from OpenMC
   bool getResults(std::map<std::string,std::vector< double > > & var_results_by_elem);
-  /// Set solution in FEProblem variable
+  /// Append the results of a cell tally to those of the corresponding mesh tally
+  bool getCellResults(int32_t tally_id,
+                      const std::vector<ScoreData>& scores,
+                      std::map<std::string,std::vector< double > > & var_results_by_elem);
+  /// Blend new tally results with those of previous iterations
+  void relaxResults(std::map<std::string,std::vector< double > > & var_results_by_elem);
+  /// Set solution in FEProblem variable (mat_factors rescales each material of a functional expansion)
   bool setSolution(std::vector< double > & results_by_elem,
                    std::string var_name,
                    double scale_factor,
-                   bool isErr);
+                   bool isErr,
+                   const std::vector< double > & mat_factors);
 
   // Helper methods to extract tally results
 
@@ -180,14 +287,64 @@ private:
   /// Update mesh tallies
   void updateMeshTallies();
 
+  /// Create the mesh on which OpenMC scores tallies
+  std::unique_ptr<openmc::Mesh> createTallyMesh();
+
+  /// Find which coarse tally bins each element receives results from
+  void updateTallyMap();
+
+  /// Get the centre of a coarse tally bin
+  bool getBinCentroid(const openmc::Mesh& tally_mesh, int bin, openmc::Position& r);
+
   /// Set up OpenMC tallies
-  void setupTallies(openmc::Filter* filter_ptr);
+  void setupTallies(const std::vector<openmc::Filter*>& filters);
 
   /// Set up an OpenMC tally
   void setupTally(int32_t& tally_id,
-                  openmc::Filter* filter_ptr,
+                  const std::vector<openmc::Filter*>& filters,
                   std::vector<ScoreData>& scores);
 
+  /// Set up tallies of functional expansion coefficients for each material
+  void initFETallies();
+
+  /// Update functional expansion tallies for new materials and mesh position
+  void updateFETallies();
+
+  /// Set the materials and the domain of the functional expansion
+  void setFEDomain();
+
+  /// Extract functional expansion coefficients for each MOOSE material
+  bool getFEResults(std::map<std::string,std::vector< double > > & var_results_by_elem);
+
+  /// Check the number of functional expansion coefficients matches the expansion order
+  bool checkFECoeffs(const std::vector< double > & coeffs);
+
+  /// Evaluate the expansion (or its standard deviation) for a material at the centroid of an element
+  double evalExpansion(const std::vector< double > & coeffs,
+                       const Elem& elem,
+                       int iMat,
+                       bool isErr);
+
+  /// Get the factors by which each material's expansion is rescaled to conserve its tallied total
+  bool getFEFactors(const std::vector< double > & coeffs,
+                    std::vector< double > & mat_factors);
+
+  /// Reconstruct a functional expansion on the elements, rescaled by mat_factors
+  bool setFESolution(std::vector< double > & coeffs,
+                     const std::vector< double > & mat_factors,
+                     std::string var_name,
+                     double scale_factor,
+                     bool isErr);
+
+  /// Create the filter on the cells of regions scored by cell
+  openmc::Filter* createCellFilter();
+
+  /// Set up cell tallies for regions outside the materials tallied on the mesh
+  void setupCellTallies();
+
+  /// Point the cell filter at the current cells of regions scored by cell
+  void updateCellTallies();
+
   /// Set up OpenMC cells
   //bool setupCells();
 
@@ -214,12 +371,36 @@ private:
   /// Constant for geometric surface dimension
   static constexpr int DIM_SURF = 2;
 
+  /// Maximum number of points in a leaf of the element centroid search tree
+  static constexpr unsigned int kdTreeLeafSize = 10;
+
   /// Copy of the pointer to DAGMC
   std::shared_ptr<moab::DagMC> dagPtr;
 
+  /// Name of the MoabUserObject which generates the geometry
+  UserObjectName moab_name;
+
   /// OpenMC index for DAGMC universe
   int32_t dag_univ_idx;
 
+  /// OpenMC ID for DAGMC universe generated by MOAB
+  int32_t dag_univ_id;
+
+  /// Number of cells belonging to static universes
+  size_t n_static_cells;
+
+  /// Number of surfaces belonging to static universes
+  size_t n_static_surfs;
+
+  /// IDs referenced by each static cell
+  std::vector<StaticCellIDs> static_cell_ids;
+
+  /// Universe IDs of each lattice tile, by lattice
+  std::vector< std::vector<int32_t> > lattice_univ_ids;
+
+  /// Universe ID outside each lattice
+  std::vector<int32_t> lattice_outer_ids;
+
   /// Record whether we set the FE Problem locally.
   bool setProblemLocal;
 
@@ -235,6 +416,12 @@ private:
   /// Save whether we have a UWUW material library
   bool useUWUW;
 
+  /// Switch to control whether the DAGMC universe is built from MOAB at startup
+  bool skip_placeholder_geometry;
+
+  /// Switch to control whether OpenMC is initialised concurrently with MOAB
+  bool concurrent_init;
+
   /// Hold OpenMC error code
   int openmc_err;
 
@@ -244,6 +431,98 @@ private:
   /// Map of OpenMC IDs of the tallies to list of score and variable names
   std::map<int32_t, std::vector<ScoreData> > tally_ids_to_scores;
 
+  /// Map of OpenMC IDs of the tallies to any requested estimator
+  std::map<int32_t, openmc::TallyEstimator> tally_ids_to_estimator;
+
+  /// Map of OpenMC IDs of the mesh tallies to IDs of the corresponding cell tallies
+  std::map<int32_t, int32_t> cell_tally_ids;
+
+  /// Filter on the cells of regions outside the materials tallied on the mesh
+  openmc::CellFilter* cell_filter;
+
+  /// Type of relaxation to apply to results between iterations
+  MooseEnum relaxation;
+
+  /// Relaxation factor to use for constant relaxation
+  double relaxation_factor;
+
+  /// Map of variable name to history of relaxed results
+  std::map<std::string, RelaxData> relaxed_results;
+
+  /// Type of tally from which results are extracted
+  MooseEnum tally_type;
+
+  /// Switch to control whether tracks cross the MOAB tally mesh by walking between neighbouring tets
+  bool walk_tally_mesh;
+
+  /// Order of radial Zernike expansion
+  unsigned int fe_zernike_order;
+
+  /// Order of axial Legendre expansion
+  unsigned int fe_legendre_order;
+
+  /// Filter on the tally mesh
+  openmc::MeshFilter* mesh_filter;
+
+  /// OpenMC index of the tally mesh
+  int32_t tally_mesh_idx;
+
+  /// Filters for functional expansion tallies
+  openmc::MaterialFilter* fe_mat_filter;
+  openmc::ZernikeFilter* fe_zernike_filter;
+  openmc::SpatialLegendreFilter* fe_legendre_filter;
+
+  /// Number of MOOSE materials with a functional expansion
+  size_t n_fe_mats;
+
+  /// MOOSE material index of each OpenMC material index (-1 if none)
+  std::vector<int> moose_mat_by_idx;
+
+  /// MOOSE material index of each material filter bin
+  std::vector<int> fe_mat_bins;
+
+  /// Domain of the functional expansion (MOOSE units)
+  Point fe_centre;
+  double fe_radius;
+  double fe_zmin;
+  double fe_zmax;
+
+  /// Switch to control whether eigenvalue runs are seeded with the previous fission source
+  bool reuse_source;
+
+  /// Number of inactive batches once the fission source is reused
+  unsigned int reused_source_inactive;
+
+  /// Switch to control whether weight windows are generated from the flux
+  bool weight_windows;
+
+  /// Ratio of upper to lower weight window bounds
+  double ww_ratio;
+
+  /// Index of our weight windows in OpenMC
+  int32_t ww_idx;
+
+  /// Name of the variable holding the flux from which weight windows are generated
+  std::string ww_var_name;
+
+  /// Switch to control whether transport is only rerun if inputs change
+  bool lazy_transport;
+
+  /// Maximum change in the binned variable before transport is rerun
+  double lazy_max_change;
+
+  /// Maximum RMS change in the binned variable before transport is rerun
+  double lazy_rms_change;
+
+  /// Maximum fraction of elements changing bin before transport is rerun
+  double lazy_rebin_fraction;
+
+  /// Maximum number of consecutive skipped transport solves
+  unsigned int lazy_max_skipped;
+
+  /// Number of consecutive skipped transport solves
+  unsigned int n_skipped;
+
   /// Convenience map of mat name string to its id
   std::map<std::string,int32_t> mat_names_to_id;
 
@@ -262,6 +541,66 @@ private:
   /// Number of threads to use if launch_threads = true
   unsigned int n_threads;
 
+  /// Switch to control whether OpenMC borrows MOOSE's threads during runs
+  bool share_threads;
+
+  /// Switch to control whether transport lags MOOSE by one step and runs concurrently
+  bool lagged_coupling;
+
+  /// Handle to the result of a background OpenMC run
+  std::future<int> pending_run;
+
+  /// Save whether a background run was launched on the last step
+  bool runPending;
+
+  /// Number of ranks on which to run OpenMC (0 = all)
+  unsigned int openmc_procs;
+
+  /// Number of ranks per shared-memory node on which to run OpenMC (0 = no limit)
+  unsigned int openmc_procs_per_node;
+
+  /// Save whether this rank runs OpenMC
+  bool runsOpenMC;
+
+  /// Save whether every rank runs OpenMC
+  bool allRunOpenMC;
+
+  /// Switch to control whether ranks receive results for only the bins of their local elements
+  bool scatter_results;
+
+  /// Save whether the bins needed by each rank must be collected again
+  bool resultBinsOutdated;
+
+  /// Number of bins needed by each rank (master only)
+  std::vector<int> scatter_counts;
+
+  /// Concatenated bins needed by each rank (master only)
+  std::vector<unsigned int> scatter_bins;
+
+  /// Number of bins needed by this rank
+  int n_local_bins;
+
+  /// Number of extra ranks launched to help run transport
+  unsigned int helper_procs;
+
+  /// Switch to control whether this app only helps another app run transport
+  bool transport_helper;
+
+  /// Save whether the helpers have been told to finish
+  bool helpersFinished;
+
+  /// Communicator passed to OpenMC
+  MPI_Comm openmc_comm;
+
+  /// Communicator between the OpenMC master of the app and the helpers
+  MPI_Comm helper_comm;
+
+  /// Save whether this is rank 0 of the OpenMC communicator
+  bool isOpenMCMaster;
+
+  /// Tag identifying the connection to the helpers
+  static constexpr int helper_tag = 3030;
+
   /// Switch to control whether dagmc output is written to file or not.
   bool redirect_dagout;
 
@@ -283,6 +622,10 @@ private:
   PerfID _updateopenmc_timer;
   /// Performance timer for OpenMC runs
   PerfID _run_timer;
+  /// Performance timer for waiting on background OpenMC runs
+  PerfID _wait_timer;
+  /// Performance timer for waiting on OpenMC to start up concurrently with MOAB
+  PerfID _waitopenmc_timer;
   /// Performance timer for writing output in standalone mode
   PerfID _output_timer;
 
@@ -0,0 +1,59 @@
+#pragma once
+
+// OpenMC includes
+#include "openmc/mesh.h"
+#include "openmc/position.h"
+
+// MOAB includes
+#include "moab/Core.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+/**
+    \brief Unstructured MOAB tally mesh which follows tracks through
+    the tetrahedra by walking across their faces.
+
+    Each track segment is located once (or continues from the tet in
+    which the previous segment on this thread ended), then crosses from
+    tet to tet through the face by which it leaves. Segments which start
+    outside the mesh, or leave it, are handed back to the base class.
+ */
+class WalkingMOABMesh : public openmc::MOABMesh
+{
+public:
+
+  WalkingMOABMesh(std::shared_ptr<moab::Interface> external_mbi);
+
+  /// Find the bins crossed by a track segment and the fraction of its length in each
+  void bins_crossed(openmc::Position r0,
+                    openmc::Position r1,
+                    const openmc::Direction& u,
+                    std::vector<int>& bins,
+                    std::vector<double>& lengths) const override;
+
+private:
+
+  /// Planes and neighbours of the faces of a tet
+  struct TetFaces {
+    /// Outward unit normal of the face opposite each vertex
+    std::array<openmc::Direction,4> normals;
+    /// Offset of each face plane, such that normal.r = offset on the face
+    std::array<double,4> offsets;
+    /// Bin of the tet across each face (-1 on the boundary)
+    std::array<int,4> neighbours;
+  };
+
+  /// Build the face planes and face adjacency of all tets
+  void setTetFaces(moab::Interface& mbi);
+
+  /// Check if a point lies in the tet of a bin
+  bool inBin(const openmc::Position& r, int bin) const;
+
+  /// Face data by bin (empty if the tets are not contiguous, in which case we never walk)
+  std::vector<TetFaces> tet_faces;
+
+  /// Tolerance on the distance of a point outside a face
+  static constexpr double faceTol = 1.e-10;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "GeneralPostprocessor.h"
+
+/** \brief Report the eigenvalue or Shannon entropy of the last OpenMC
+    eigenvalue run
+*/
+class OpenMCEigenvalue : public GeneralPostprocessor
+{
+public:
+  static InputParameters validParams();
+
+  OpenMCEigenvalue(const InputParameters & parameters);
+
+  virtual void initialize() override {};
+
+  /// Fetch the value from OpenMC on the master and share it
+  virtual void execute() override;
+
+  virtual Real getValue() const override { return _value; };
+
+protected:
+
+  /// Quantity to report
+  MooseEnum _value_type;
+
+  /// Last value fetched from OpenMC
+  Real _value;
+
+};
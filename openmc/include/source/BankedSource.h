@@ -0,0 +1,32 @@
+#pragma once
+
+// OpenMC includes
+#include "openmc/particle_data.h"
+#include "openmc/source.h"
+
+#include <vector>
+
+/**
+    \brief Source which samples sites saved from the fission bank of a
+    previous eigenvalue run.
+
+    Each rank keeps its own share of the bank in memory, so no source
+    file is written and nothing needs to be communicated.
+ */
+class BankedSource : public openmc::Source
+{
+public:
+
+  BankedSource(const openmc::SourceSite* sites, size_t n_sites);
+
+  /// Sample one of the saved sites uniformly
+  openmc::SourceSite sample(uint64_t* seed) const override;
+
+  /// Get the saved sites
+  const std::vector<openmc::SourceSite>& sites() const { return sites_; };
+
+private:
+
+  /// Sites saved from the fission bank
+  std::vector<openmc::SourceSite> sites_;
+};
@@ -20,6 +20,11 @@
 #include <libmesh/mesh_tools.h>
 #include <libmesh/mesh_function.h>
 
+#include <array>
+#include <functional>
+#include <cstdint>
+#include <numeric>
+
 /// Convenience struct
 struct MOABMaterialProperties{
   double rel_density;
@@ -81,15 +86,84 @@ class MoabUserObject : public UserObject
   /// Update MOAB with any results from MOOSE
   bool update();
 
+  /// Check if the last update had to create new tets
+  bool hasNewTets(){ return tetsRebuilt; };
+
+  /// Check if the last update moved existing tets
+  bool hasMovedTets(){ return tetsMoved; };
+
+  /// Check if the last update rebuilt the geometry
+  bool hasNewGeometry(){ return geomRebuilt; };
+
+  /// Maximum displacement of a MOAB vertex found during the last update (in MOAB length units)
+  double maxDisplacement(){ return maxDisp; };
+
+  /// Check if tallies are scored on the libMesh mesh directly, in which case MOAB only holds the skins
+  bool tallyOnLibMesh(){ return tallyMeshType == "libmesh"; };
+
+  /// Check if every binned region is scored by a cell tally, without any tally mesh
+  bool tallyOnCells(){ return tallyMeshType == "cell"; };
+
+  /// Check if tallies are scored on a coarse mesh whose results are projected onto the elements
+  bool hasCoarseTallyMesh(){ return coarseTally; };
+
+  /// Get the type of mesh on which OpenMC scores tallies
+  std::string getTallyMeshType(){ return tallyMeshType; };
+
+  /// Get the name of the file containing the coarse tally mesh
+  std::string getTallyMeshFile(){ return tallyMeshFile; };
+
+  /// Get the number of cells in each direction of a regular tally mesh
+  const std::vector<unsigned int>& getTallyMeshDimension(){ return tallyMeshDimension; };
+
+  /// Set the coarse tally bins which overlap each element (bins are shared by volume)
+  void setCoarseTallyBins(const std::map<dof_id_type,std::vector<unsigned int> >& binsByElem);
+
+  /// Get the sorted tally bins from which local elements receive results
+  void getLocalTallyBins(std::vector<unsigned int>& bins);
+
+  /// Set the bins held, in order, by results vectors passed to setSolution (empty = indexed by bin)
+  void setResultBins(const std::vector<unsigned int>& bins){ resultBins = bins; };
+
+  /// Return the centroid position of an element
+  Point elemCentroid(const Elem& elem);
+
+  /// Get a reference to the libMesh mesh whose elements are binned
+  MeshBase& getMesh(){ return mesh(); };
+
+  /// Get the scale factor to convert MOOSE lengths to MOAB lengths
+  double getLengthScale(){ return lengthscale; };
+
+  /// Check if regions outside the tallied materials should be scored by a cell tally
+  bool hasCellTallies(){ return cellTallies; };
+
+  /// Get the ids of the volumes to score in a cell tally, in order of their results bins
+  const std::vector<int>& getCellTallyVols(){ return cellTallyVols; };
+
+  /// Set whether this process builds the DAGMC geometry, or only bins elements (unless surfaces are distributed)
+  void setBuildGeometry(bool build){ buildGeometry = build; };
+
+  /// Measure the change in the binned variable since elements were last sorted (false if there is nothing to compare to)
+  bool getBinningChange(double& maxChange, double& rmsChange, double& rebinFraction);
+
   /// Pass the OpenMC results into the libMesh systems solution
   bool setSolution(std::string var_now,std::vector< double > &results, double scaleFactor=1., bool isErr=false, bool normToVol=true);
 
+  /// Pass a field evaluated on each element into the libMesh systems solution
+  bool setSolution(std::string var_now, const std::function<double(const Elem&)>& field);
+
+  /// Get the index of the material to which an element belongs (-1 if none)
+  int getMaterialIndex(const Elem& elem);
+
   /// Retrieve a list of original material names and properties
   void getMaterialProperties(std::vector<std::string>& mat_names_out,
                              std::vector<double>& initial_densities,
                              std::vector<std::string>& tails,
                              std::vector<MOABMaterialProperties>& properties);
 
+  /// Copy the MOAB database and the metadata OpenMC needs from rank 0 of comm to its other ranks, which don't build it themselves
+  bool shareGeometry(MPI_Comm comm);
+
   /// Publically available pointer to MOAB interface
   std::shared_ptr<moab::Interface> moabPtr;
 
@@ -121,9 +195,34 @@ private:
 
   /// Helper method to create MOAB nodes
   moab::ErrorCode createNodes(std::map<dof_id_type,moab::EntityHandle>& node_id_to_handle);
+  /// Create vertices for the nodes on the skins of the binned regions which don't have one yet
+  moab::ErrorCode createSkinNodes();
+  /// Create vertices for some nodes, in the requested order
+  moab::ErrorCode createVerts(const std::vector<const Node*>& nodes);
   /// Helper method to create MOAB elements
   void createElems(std::map<dof_id_type,moab::EntityHandle>& node_id_to_handle);
 
+  /// Sort points into the requested space-filling curve order, returning the permutation
+  std::vector<size_t> curveOrder(const std::vector<Point>& points);
+
+  /// Return the Morton (z-order) key of integer coordinates
+  uint64_t mortonKey(const std::array<uint32_t,3>& coords);
+
+  /// Return the Hilbert key of integer coordinates
+  uint64_t hilbertKey(std::array<uint32_t,3> coords);
+
+  /// Check whether the existing MOAB tets still correspond to the libMesh mesh
+  bool canReuseTets();
+
+  /// Get the indices of the tally bins which belong to a libMesh element, and the fraction of each bin it receives
+  void getTallyBins(const Elem& elem, std::vector<unsigned int>& bins, std::vector<double>& weights);
+
+  /// Assign a region scored by a cell tally to the next results bin
+  void addCellTallyRegion(const std::set<dof_id_type>& region, int vol_id);
+
+  /// Update the coordinates of MOAB nodes if the (displaced) libMesh mesh has moved by more than geom_tol
+  bool updateCoords();
+
   /// Helper method to create MOAB tags
   moab::ErrorCode createTags();
 
@@ -169,6 +268,18 @@ private:
   /// Return all sets of node indices for sub-tetrahedra if we have a second order mesh
   bool getTetSets(ElemType type, std::vector< std::vector<unsigned int> > &perms);
 
+  /// Return all sets of node indices for the sub-tetrahedra of an element (index n_nodes denotes its centroid)
+  bool getTetSets(const Elem& elem, std::vector< std::vector<unsigned int> > &perms);
+
+  /// Split a quad face of an element into two tris, consistently with its neighbour
+  void splitQuad(const Elem& elem, const std::vector<unsigned int>& quad, std::vector< std::vector<unsigned int> >& tris);
+
+  /// Reorder the nodes of a sub-tetrahedron to have positive volume
+  void orientTet(const Elem& elem, std::vector<unsigned int>& tet);
+
+  /// Create a MOAB vertex at the centroid of an element
+  moab::ErrorCode createCentreVert(const Elem& elem, moab::EntityHandle& ent);
+
   /// Build the graveyard (needed by OpenMC)
   moab::ErrorCode buildGraveyard(unsigned int & vol_id, unsigned int & surf_id);
 
@@ -206,6 +317,11 @@ private:
   /// Sort elems in to bins of a given temperature
   bool sortElemsByResults();
 
+  /// Evaluate the binned variable at an element centroid and return its sort bin
+  int getElemSortBin(Elem& elem, unsigned int iMat, double& value,
+                     std::shared_ptr<MeshFunction> meshFunctionPtr,
+                     std::shared_ptr<MeshFunction> denMeshFunctionPtr);
+
   /// Group the binned elems into local temperature regions and find their surfaces
   bool findSurfaces();
 
@@ -213,6 +329,27 @@ private:
   /// NB elems in param is a copy, localElems is a reference
   void groupLocalElems(std::set<dof_id_type> elems, std::vector<moab::Range>& localElems);
 
+  /// Group a given bin into local regions of libMesh element ids
+  void groupLocalElems(std::set<dof_id_type> elems, std::vector< std::set<dof_id_type> >& localElems);
+
+  /// Group and skin the regions of each bin on one process, share out sorting the tris into surfaces, then build the geometry everywhere
+  bool findSurfacesDistributed(unsigned int & vol_id, unsigned int & surf_id);
+
+  /// Assign regions scored by a cell tally to results bins, numbering volumes as findSurfaces would, without building them
+  void numberCellTallyRegions();
+
+  /// Get the outward vertices of the skin tris of a region of tets
+  moab::ErrorCode skinTriVerts(const moab::Range& tets, std::vector< std::vector<moab::EntityHandle> >& triVerts);
+
+  /// Get the outward vertices of the tris on the libMesh element sides bounding a region
+  void sideTriVerts(const std::set<dof_id_type>& region, std::vector< std::vector<moab::EntityHandle> >& triVerts);
+
+  /// Create tris from the libMesh element sides on the boundary of a region
+  moab::ErrorCode skinFromSides(const std::set<dof_id_type>& region, moab::Range& tris, moab::Range& rtris);
+
+  /// Fetch the tri with the given vertices, creating it if it does not yet exist
+  moab::ErrorCode getSkinTri(const std::vector<moab::EntityHandle>& verts, moab::Range& tris, moab::Range& rtris);
+
   /// Given a value of our variable, find what bin this corresponds to.
   int getResultsBin(double value);
   /// Find results bin if we have linear binning
@@ -251,18 +388,24 @@ private:
   /// Calculate a generic variable midpoints given binning params
   void calcMidpointsLin(double var_min_in, double bin_width_in,int nbins_in,std::vector<double>& midpoints_in);
 
-  /// Return the centroid position of an element
-  Point elemCentroid(Elem& elem);
-
   /// Clear the containers of elements grouped into bins of constant temp
   void resetContainers();
 
+  /// Update our serialised copies of the solution
+  void updateSerialSolutions();
+
   /// Clear MOAB entity sets
   bool resetMOAB();
 
+  /// Delete geometry entity sets and graveyard, keeping the tets
+  bool resetGeometry();
+
   /// Find the surfaces for the provided range and add to group
   bool findSurface(const moab::Range& region,moab::EntityHandle group, unsigned int & vol_id, unsigned int & surf_id,moab::EntityHandle& volume_set);
 
+  /// Create a volume bounded by the provided skin and add to group
+  bool createVolume(moab::Range& tris, moab::Range& rtris, moab::EntityHandle group, unsigned int & vol_id, unsigned int & surf_id,moab::EntityHandle& volume_set);
+
   /// Write to file
   bool write();
 
@@ -290,6 +433,105 @@ private:
   /// Save the first tet entity handle
   moab::EntityHandle offset;
 
+  /// Type of mesh on which OpenMC scores tallies
+  MooseEnum tallyMeshType;
+
+  /// Switch to control whether tallies use a mesh other than the MOAB tets, so that MOAB only holds skins
+  bool skinOnly;
+
+  /// Switch to control whether tallies are scored on a coarse mesh
+  bool coarseTally;
+
+  /// Name of a file containing a coarse tally mesh
+  std::string tallyMeshFile;
+
+  /// Number of cells in each direction for a regular tally mesh
+  std::vector<unsigned int> tallyMeshDimension;
+
+  /// Map from libMesh id to coarse tally bins and the element's share of each
+  std::map<dof_id_type, std::vector< std::pair<unsigned int,double> > > coarseBinsByElem;
+
+  /// Tally bins held by compact results vectors, if not indexed by bin
+  std::vector<unsigned int> resultBins;
+
+  /// Save the id of the first libMesh element (used to number bins when tallying on libMesh)
+  dof_id_type firstElemId;
+
+  /// Number of active libMesh elements when MOAB was initialised
+  dof_id_type nElemsInit;
+
+  /// Number of libMesh nodes when MOAB was initialised
+  dof_id_type nNodesInit;
+
+  /// Map from sorted vertex handles to the skin tris created from libMesh sides
+  std::map<std::array<moab::EntityHandle,3>, moab::EntityHandle> skinTris;
+
+  /// Number of tets in the tally mesh
+  size_t nTets;
+
+  /// Order in which elements and nodes are created in MOAB
+  MooseEnum elemOrdering;
+
+  /// Number of bits per dimension of space-filling curve keys
+  static constexpr unsigned int curveBits = 21;
+
+  /// Switch to control whether surface construction is shared between processes
+  bool distributedSurfaces;
+
+  /// Switch to control whether this process builds the DAGMC geometry
+  bool buildGeometry;
+
+  /// Switch to control whether second order elements are tallied on a single tet of their corner nodes
+  bool tallyParents;
+
+  /// Switch to control whether skins of second order elements use only corner nodes
+  bool coarseSkins;
+
+  /// Switch to control whether all skins are built from libMesh sides
+  bool sideSkins;
+
+  /// Names of the materials whose elements are tallied on the mesh (empty means all)
+  std::vector<std::string> tally_mat_names;
+
+  /// Whether each material bin is tallied on the mesh
+  std::vector<bool> matTallied;
+
+  /// Blocks whose elements are tallied on the mesh (empty means all)
+  std::set<SubdomainID> tallyBlocks;
+
+  /// Switch to control whether regions outside the tallied materials are scored by a cell tally
+  bool cellTallies;
+
+  /// Ids of the volumes scored by a cell tally
+  std::vector<int> cellTallyVols;
+
+  /// Map from libMesh id to cell tally results bin and the element's fraction of the region volume
+  std::map<dof_id_type, std::pair<unsigned int,double> > cellBinsByElem;
+
+  /// Map from libmesh node id to MOAB vertex entity handles
+  std::map<dof_id_type,moab::EntityHandle> node_id_to_handle;
+
+  /// Map from libmesh element id to the MOAB vertex at its centroid (hexahedra only)
+  std::map<dof_id_type,moab::EntityHandle> centreVerts;
+
+  /// Entities belonging to the graveyard
+  moab::Range graveyardEnts;
+
+  /// Save whether the last update created new tets
+  bool tetsRebuilt;
+
+  /// Save whether the last update moved the tets
+  bool tetsMoved;
+
+  /// Save whether the last update rebuilt the geometry
+  bool geomRebuilt;
+
+  /// Save whether any element changed sort bin in the last sort
+  bool binsChanged;
+
+  /// Maximum displacement of a vertex found in the last update
+  double maxDisp;
+
   // Data members relating to binning in temperature
 
   /// Name of the MOOSE variable
@@ -339,6 +581,12 @@ private:
   /// Container for elems sorted by variable bin and materials
   std::vector<std::set<dof_id_type> > sortedElems;
 
+  /// Value of the binned variable for local elems when last sorted
+  std::map<dof_id_type,double> sortedValues;
+
+  /// Sort bin of local elems when last sorted
+  std::map<dof_id_type,int> sortedBins;
+
   /// A map to store mesh functions against their variable name
   std::map<std::string, std::shared_ptr<MeshFunction> > meshFunctionPtrs;
 
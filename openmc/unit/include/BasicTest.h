@@ -3,6 +3,8 @@
 #include "gtest/gtest.h"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "AppFactory.h"
 #include "MooseObject.h"
@@ -11,7 +13,7 @@ class BasicTest : public ::testing::Test {
 
  protected:
 
-  BasicTest(std::string appNameIn) : args(""), appName(appNameIn), appIsNull(true) {};
+  BasicTest(std::string appNameIn) : args(""), appName(appNameIn), appIsNull(true), appComm(MPI_COMM_WORLD) {};
 
   virtual void SetUp() override {};
 
@@ -23,28 +25,30 @@ class BasicTest : public ::testing::Test {
 
   void createApp() {
 
-    // Convert string arguments to char array
-    char * cstr = new char [args.length()+1];
-    std::strcpy (cstr, args.c_str());
-
-    // Split string by whitespace delimiter
-    std::vector<char*> arg_list;
-    char * next;
-    next = strtok(cstr," ");
-    while (next != NULL){
-      arg_list.push_back(next);
-      next = strtok(NULL, " ");
+    // Split string by whitespace delimiter, keeping quoted values
+    // (e.g. vector parameters) in one argument
+    std::vector<std::string> arg_list;
+    std::string next;
+    bool quoted = false;
+    for(const char c : args){
+      if(c == '\'') quoted = !quoted;
+      if(c == ' ' && !quoted){
+        if(!next.empty()) arg_list.push_back(next);
+        next.clear();
+      }
+      else next += c;
     }
+    if(!next.empty()) arg_list.push_back(next);
 
     // Create array of char*
     size_t argc = arg_list.size();
     char ** argv = new char*[argc];
     for (size_t i = 0; i < argc; i++){
-      argv[i]=arg_list.at(i);
+      argv[i]=&(arg_list.at(i)[0]);
     }
 
     try {
-      app = AppFactory::createAppShared(appName, argc, argv);
+      app = AppFactory::createAppShared(appName, argc, argv, appComm);
       appIsNull = ( app == nullptr );
     }
     catch(std::exception& e){
@@ -53,8 +57,7 @@ class BasicTest : public ::testing::Test {
     }
 
     // Deallocate memory for C arrays created with new
-    delete argv;
-    delete cstr;
+    delete[] argv;
   };
 
   void checkKnownObjects(const std::vector<std::string>& knownObjNames){
@@ -112,6 +115,9 @@ class BasicTest : public ::testing::Test {
 
   bool appIsNull;
 
+  // Communicator for our Moose App
+  MPI_Comm appComm;
+
 };
 
 class InputFileTest : public BasicTest {
@@ -519,6 +519,66 @@ protected:
   };
 };
 
+// Test for elements created along a Hilbert curve
+class CurveOrderMoabUserObjectTest : public MoabUserObjectTest {
+protected:
+  CurveOrderMoabUserObjectTest() :
+    MoabUserObjectTest("curveorder.i") {};
+};
+
+// Test for second-order mesh tallied on parent elements
+class ParentElemMoabUserObjectTest : public MoabUserObjectTest {
+protected:
+  ParentElemMoabUserObjectTest() :
+    MoabUserObjectTest("secondordermesh.i") {
+    args+=" UserObjects/moab/tally_parent_elems=true";
+
+    // Override defaults
+    nNodesExpect=65;
+    nElemsExpect=24;
+
+  };
+};
+
+// Test for hexahedral mesh split into tetrahedra about each centroid
+class HexMoabUserObjectTest : public MoabUserObjectTest {
+protected:
+  HexMoabUserObjectTest() :
+    MoabUserObjectTest("hexelems.i") {
+
+    // Override defaults: includes a vertex per element centroid
+    nNodesExpect=14;
+    nElemsExpect=24;
+
+  };
+};
+
+// Test for prismatic mesh split into tetrahedra
+class PrismMoabUserObjectTest : public MoabUserObjectTest {
+protected:
+  PrismMoabUserObjectTest() :
+    MoabUserObjectTest("prismelems.i") {
+
+    // Override defaults
+    nNodesExpect=8;
+    nElemsExpect=6;
+
+  };
+};
+
+// Test for results on a coarse tally mesh
+class CoarseTallyMoabUserObjectTest : public MoabUserObjectTest {
+protected:
+  CoarseTallyMoabUserObjectTest() :
+    MoabUserObjectTest("coarsetally.i") {
+
+    // Override defaults
+    nNodesExpect=15;
+    nElemsExpect=24;
+
+  };
+};
+
 class FindMoabSurfacesTest : public MoabUserObjectTest {
 protected:
   FindMoabSurfacesTest() :
@@ -1154,6 +1214,66 @@ protected:
     }
   }
 
+  // Check there is one tri per skin face besides the graveyard, and that
+  // surface 1 is the copper-air interface, facing out of the copper
+  void checkSkinTris(){
+    size_t nBoundary = 0;
+    size_t nInterface = 0;
+    MeshBase& mesh = problemPtr->mesh().getMesh();
+    for(const auto & elem : mesh.active_element_ptr_range()){
+      for(unsigned int iSide=0; iSide<elem->n_sides(); iSide++){
+        const Elem* nnptr = elem->neighbor_ptr(iSide);
+        if(nnptr == nullptr) nBoundary++;
+        else if(nnptr->subdomain_id() != elem->subdomain_id()) nInterface++;
+      }
+    }
+    // Each interface face was seen from both sides
+    nInterface /= 2;
+
+    std::shared_ptr<moab::Interface> moabPtr = moabUOPtr->moabPtr;
+    moab::Range tris;
+    ASSERT_EQ(moabPtr->get_entities_by_type(0,moab::MBTRI,tris),moab::MB_SUCCESS);
+    EXPECT_EQ(tris.size(),nBoundary+nInterface+24);
+
+    moab::EntityHandle surf;
+    getEntFromID(1,"Surface",surf);
+    moab::Range surfTris;
+    ASSERT_EQ(moabPtr->get_entities_by_type(surf,moab::MBTRI,surfTris),moab::MB_SUCCESS);
+    EXPECT_EQ(surfTris.size(),nInterface);
+
+    moab::GeomTopoTool GTT(moabPtr.get(), false);
+    std::vector<moab::EntityHandle> vols;
+    std::vector<int> senses;
+    ASSERT_EQ(GTT.get_senses(surf,vols,senses),moab::MB_SUCCESS);
+    ASSERT_EQ(vols.size(),size_t(2));
+    for(size_t iVol=0; iVol<vols.size(); iVol++){
+      int vol_id;
+      getEntityID(vols.at(iVol),vol_id);
+      EXPECT_EQ(senses.at(iVol),(vol_id == 1) ? 1 : -1)
+        << "Unexpected sense for volume "<< vol_id;
+    }
+  }
+
+  // Check only the nodes on block boundaries have vertices, besides the graveyard corners
+  void checkSkinNodes(){
+    std::set<dof_id_type> skinNodes;
+    MeshBase& mesh = problemPtr->mesh().getMesh();
+    for(const auto & elem : mesh.active_element_ptr_range()){
+      for(unsigned int iSide=0; iSide<elem->n_sides(); iSide++){
+        const Elem* nnptr = elem->neighbor_ptr(iSide);
+        if(nnptr != nullptr && nnptr->subdomain_id() == elem->subdomain_id()) continue;
+        for(unsigned int iNode=0; iNode<elem->n_nodes(); iNode++){
+          if(elem->is_node_on_side(iNode,iSide)) skinNodes.insert(elem->node_id(iNode));
+        }
+      }
+    }
+    EXPECT_LT(skinNodes.size(),size_t(mesh.n_nodes()));
+
+    moab::Range verts;
+    ASSERT_EQ(moabUOPtr->moabPtr->get_entities_by_type(0,moab::MBVERTEX,verts),moab::MB_SUCCESS);
+    EXPECT_EQ(verts.size(),skinNodes.size()+16);
+  }
+
   void checkConstTempSurfs(double solConst,unsigned int nVol,unsigned int nSurf,int nDegen=1){
 
     // Set a constant solution
@@ -1219,6 +1339,76 @@ protected:
 
 };
 
+// Repeat surfaces test with MoabUserObject options for the feature under test
+class FeatureSurfacesTest : public FindMoabSurfacesTest {
+protected:
+
+  FeatureSurfacesTest(std::string options) :
+    FindMoabSurfacesTest("findsurfstest.i") {
+    args+=" UserObjects/moab/output_skins=false "+options;
+    initMats();
+  }
+
+};
+
+// Repeat surfaces test with skins built from libMesh sides
+class SkinOnlySurfacesTest : public FeatureSurfacesTest {
+protected:
+
+  SkinOnlySurfacesTest() :
+    FeatureSurfacesTest("UserObjects/moab/tally_mesh_type=regular UserObjects/moab/tally_mesh_dimension='2 2 2'") {}
+
+};
+
+// Repeat surfaces test tallying on the libMesh mesh
+class LibMeshSurfacesTest : public FeatureSurfacesTest {
+protected:
+
+  LibMeshSurfacesTest() :
+    FeatureSurfacesTest("UserObjects/moab/tally_mesh_type=libmesh") {}
+
+};
+
+// Repeat surfaces test with every region scored by a cell tally
+class CellTallySurfacesTest : public FeatureSurfacesTest {
+protected:
+
+  CellTallySurfacesTest() :
+    FeatureSurfacesTest("UserObjects/moab/tally_mesh_type=cell") {}
+
+};
+
+// Repeat surfaces test with skinning shared between processes
+class DistributedSurfacesTest : public FeatureSurfacesTest {
+protected:
+
+  DistributedSurfacesTest() :
+    FeatureSurfacesTest("UserObjects/moab/distributed_surfaces=true") {}
+
+};
+
+// Repeat surfaces test with skinning and surface assembly shared between two processes
+class TwoRankDistributedSurfacesTest : public DistributedSurfacesTest {
+protected:
+
+  TwoRankDistributedSurfacesTest() :
+    DistributedSurfacesTest() {
+    MPI_Comm_size(MPI_COMM_WORLD,&worldSize);
+  }
+
+  int worldSize;
+
+};
+
+// Repeat surfaces test with tets for only one material
+class TallyMatSurfacesTest : public FeatureSurfacesTest {
+protected:
+
+  TallyMatSurfacesTest() :
+    FeatureSurfacesTest("UserObjects/moab/tally_materials=copper") {}
+
+};
+
 class FindSingleMatSurfs: public FindMoabSurfacesTest {
 protected:
 
@@ -0,0 +1,34 @@
+[Mesh]
+  # Length dimensions are cm
+  type = GeneratedMesh
+  dim = 3
+  nx = 1
+  ny = 1
+  nz = 1
+  elem_type=TET4
+[]
+
+[Problem]
+  type = OpenMCProblem
+[]
+
+[Executioner]
+  type = Steady
+[]
+
+[UserObjects]
+  [moab]
+    type = MoabUserObject
+    # match up with variable below for this test
+    bin_varname = "temperature"
+    tally_mesh_type = regular
+    tally_mesh_dimension = "1 1 1"
+  []
+[]
+
+[Variables]
+  [temperature]
+    order = CONSTANT
+    family = MONOMIAL
+  []
+[]
@@ -0,0 +1,30 @@
+[Mesh]
+  [meshcm]
+    type = FileMeshGenerator
+    file = copper_air_bcs_tetmesh.e
+  []
+[]
+
+[Problem]
+  type = OpenMCProblem
+[]
+
+[Executioner]
+  type = Steady
+[]
+
+[UserObjects]
+  [moab]
+    type = MoabUserObject
+    # match up with variable below for this test
+    bin_varname = "temperature"
+    elem_ordering = hilbert
+  []
+[]
+
+[Variables]
+  [temperature]
+    order = CONSTANT
+    family = MONOMIAL
+  []
+[]
@@ -0,0 +1,35 @@
+[Mesh]
+  [meshcm]
+    type = FileMeshGenerator
+    file = copper_air_bcs_tetmesh.e
+  []
+[]
+
+[Problem]
+  type = OpenMCProblem
+[]
+
+[Executioner]
+  type = OpenMCExecutioner
+[]
+
+[Variables]
+  [heating-local]
+      order = CONSTANT
+      family = MONOMIAL
+  []
+[]
+
+[UserObjects]
+  [moab]
+    type = MoabUserObject
+    tally_mesh_type = regular
+    tally_mesh_dimension = "3 3 3"
+  []
+[]
+
+# Worryingly this is needed when multiple app tests are run in sequence
+# presumably the console object does not get properly destroyed...
+[Outputs]
+  console=false
+[]
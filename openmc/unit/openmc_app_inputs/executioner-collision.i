@@ -0,0 +1,36 @@
+[Mesh]
+  [meshcm]
+    type = FileMeshGenerator
+    file = copper_air_bcs_tetmesh.e
+  []
+[]
+
+[Problem]
+  type = OpenMCProblem
+[]
+
+[Executioner]
+  type = OpenMCExecutioner
+  variables = 'heating-local'
+  score_names = 'heating-local'
+  tally_estimators = 'collision'
+[]
+
+[Variables]
+  [heating-local]
+      order = CONSTANT
+      family = MONOMIAL
+  []
+[]
+
+[UserObjects]
+  [moab]
+    type = MoabUserObject
+  []
+[]
+
+# Worryingly this is needed when multiple app tests are run in sequence
+# presumably the console object does not get properly destroyed...
+[Outputs]
+  console=false
+[]
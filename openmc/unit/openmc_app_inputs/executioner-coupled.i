@@ -0,0 +1,65 @@
+[Mesh]
+  [meshcm]
+    type = FileMeshGenerator
+    file = copper_air_bcs_tetmesh.e
+  []
+[]
+
+[Problem]
+  type = OpenMCProblem
+[]
+
+[Executioner]
+  type = OpenMCExecutioner
+  variables = 'heating-local'
+  score_names = 'heating-local'
+  tally_ids = '1'
+  err_variables = 'heating-local-err'
+[]
+
+[Materials]
+  [copper]
+    type = ADGenericConstantMaterial
+    prop_names = 'dummy_prop'
+    prop_values = '1.0'
+    compute = false
+    block = 1
+  []
+  [air]
+    type = ADGenericConstantMaterial
+    prop_names = 'dummy_prop'
+    prop_values = '1.0'
+    compute = false
+    block = 2
+  []
+[]
+
+[Variables]
+  [temperature]
+    order = CONSTANT
+    family = MONOMIAL
+    initial_condition = 300
+  []
+  [heating-local]
+    order = CONSTANT
+    family = MONOMIAL
+  []
+  [heating-local-err]
+    order = CONSTANT
+    family = MONOMIAL
+  []
+[]
+
+[UserObjects]
+  [moab]
+    type = MoabUserObject
+    bin_varname = "temperature"
+    material_names = 'copper air'
+  []
+[]
+
+# Worryingly this is needed when multiple app tests are run in sequence
+# presumably the console object does not get properly destroyed...
+[Outputs]
+  console=false
+[]
@@ -0,0 +1,50 @@
+[Mesh]
+  [meshcm]
+    type = FileMeshGenerator
+    file = copper_air_bcs_tetmesh.e
+  []
+[]
+
+[Problem]
+  type = OpenMCProblem
+[]
+
+[Executioner]
+  type = OpenMCExecutioner
+  variables = 'heating-local flux'
+  score_names = 'heating-local flux'
+  tally_ids = '1 1'
+  err_variables = 'heating-local-err flux-err'
+  relaxation = robbins-monro
+[]
+
+[Variables]
+  [heating-local]
+      order = CONSTANT
+      family = MONOMIAL
+  []
+  [heating-local-err]
+      order = CONSTANT
+      family = MONOMIAL
+  []
+  [flux]
+      order = CONSTANT
+      family = MONOMIAL
+  []
+  [flux-err]
+      order = CONSTANT
+      family = MONOMIAL
+  []
+[]
+
+[UserObjects]
+  [moab]
+    type = MoabUserObject
+  []
+[]
+
+# Worryingly this is needed when multiple app tests are run in sequence
+# presumably the console object does not get properly destroyed...
+[Outputs]
+  console=false
+[]